@@ -1,8 +1,13 @@
 #pragma once
 
+#include <cassert>
 #include <deque>
+#include <functional>
 #include <ostream>
+#include <string>
+#include <vector>
 
+#include <fe/assert.h>
 #include <fe/cast.h>
 
 #include "let/tok.h"
@@ -17,10 +22,13 @@ public:
     virtual ~Node() {}
 
     Loc loc() const { return loc_; }
-    void dump() const;
+    void dump() const; ///< Node::write%s to `std::cout` in one go.
 
     /// Stream to @p o.
-    virtual std::ostream& stream(std::ostream& o) const = 0;
+    std::ostream& stream(std::ostream& o) const;
+
+    /// Appends the textual representation to @p buf.
+    virtual void write(std::string& buf) const = 0;
 
 private:
     Loc loc_;
@@ -29,17 +37,99 @@ private:
 template<class T> using AST  = fe::Arena::Ptr<const T>;
 template<class T> using ASTs = std::deque<AST<T>>;
 using Env                    = fe::SymMap<uint64_t>;
+using Out                    = std::function<void(uint64_t)>; ///< Receives the value of each evaluated PrintStmt.
 
 /*
  * Expr
  */
 
 /// Base class for all @p Expr%essions.
+/// Evaluating, writing, and destroying nested Expr%essions recurses up to Expr::Max_Rec_Depth and continues with an
+/// explicit work list beyond; hence, the nesting depth is only bounded by the heap.
 class Expr : public Node {
 public:
+    /// Plain recursion is fastest for the shallow Expr%essions found in practice.
+    static constexpr size_t Max_Rec_Depth = 256;
+
     Expr(Loc loc)
         : Node(loc) {}
     virtual uint64_t eval(Env&) const = 0;
+
+    /// @name Operands
+    /// Uniform view on the sub-Expr%essions used by the work list traversals.
+    ///@{
+    virtual size_t num_ops() const { return 0; }
+    virtual const Expr* op(size_t) const { fe::unreachable(); }
+    /// Combines the values @p args of the already evaluated operands.
+    virtual uint64_t fold(const uint64_t* /*args*/) const { fe::unreachable(); }
+    /// Text that precedes operand @p i while writing; `glue(num_ops())` closes the Expr%ession.
+    virtual std::string_view glue(size_t /*i*/) const { fe::unreachable(); }
+    ///@}
+
+    /// Same as Node::write but stops once @p buf exceeds @p max chars - Expr%essions may be huge.
+    void write_prefix(std::string& buf, size_t max) const {
+        if (num_ops() == 0) return write(buf);
+        write_nested(buf, max);
+    }
+
+    /// @name Folding
+    ///@{
+    struct Frame {
+        const Expr* expr;
+        size_t i, n;      // next operand to visit, number of operands
+        uint64_t args[2]; // values of the operands visited so far
+    };
+    /// Post-order traversal of @p expr on the explicit work list @p todo that Expr::fold%s the operands' values.
+    /// @p leaf yields the value of an Expr without operands - in left-to-right order; @p hook sees any other Expr right
+    /// before it is folded - while its Frame is still on top of @p todo.
+    /// Only the part of @p todo above its size on entry is touched - so reentrant calls are fine.
+    template<class Leaf, class Hook>
+    static uint64_t fold_nested(const Expr* expr, std::vector<Frame>& todo, Leaf&& leaf, Hook&& hook) {
+        if (expr->num_ops() == 0) return leaf(expr);
+
+        auto base = todo.size();
+        todo.push_back({expr, 0, expr->num_ops(), {}});
+        while (true) {
+            auto& f = todo.back();
+            if (f.i == f.n) {
+                hook(f.expr);
+                auto res = f.expr->fold(f.args);
+                todo.pop_back();
+                if (todo.size() == base) return res;
+                auto& parent              = todo.back();
+                parent.args[parent.i - 1] = res;
+                continue;
+            }
+
+            auto sub = f.expr->op(f.i++);
+            if (auto n = sub->num_ops()) {
+                assert(n <= std::size(f.args));
+                todo.push_back({sub, 0, n, {}});
+            } else {
+                f.args[f.i - 1] = leaf(sub);
+            }
+        }
+    }
+    ///@}
+
+protected:
+    /// @name Work List Traversals
+    ///@{
+    uint64_t eval_nested(Env&) const;
+    void write_nested(std::string&, size_t max = size_t(-1)) const;
+    /// Destroys the operand @p expr - without recursion once Expr::Max_Rec_Depth is exhausted.
+    static void dispose(AST<Expr>&& expr) {
+        if (!expr) return;
+        if (dispose_depth_ == Max_Rec_Depth) return dispose_nested(std::move(expr));
+        ++dispose_depth_;
+        expr.reset();
+        --dispose_depth_;
+    }
+    static void dispose_nested(AST<Expr>&& expr);
+    ///@}
+
+private:
+    static constinit inline thread_local size_t dispose_depth_ = 0;
 };
 
 class LitExpr : public Expr {
@@ -50,7 +140,7 @@ public:
 
     uint64_t u64() const { return u64_; }
 
-    std::ostream& stream(std::ostream&) const override;
+    void write(std::string&) const override;
     uint64_t eval(Env&) const override;
 
 private:
@@ -65,7 +155,7 @@ public:
 
     Sym sym() const { return sym_; }
 
-    std::ostream& stream(std::ostream&) const override;
+    void write(std::string&) const override;
     uint64_t eval(Env&) const override;
 
 private:
@@ -79,10 +169,17 @@ public:
         , tag_(tag)
         , rhs_(std::move(rhs)) {}
 
+    ~UnaryExpr() override { dispose(std::move(rhs_)); }
+
     Tok::Tag tag() const { return tag_; }
     const Expr* rhs() const { return rhs_.get(); }
 
-    std::ostream& stream(std::ostream&) const override;
+    size_t num_ops() const override { return 1; }
+    const Expr* op(size_t) const override { return rhs(); }
+    uint64_t fold(const uint64_t*) const override;
+    std::string_view glue(size_t) const override;
+
+    void write(std::string&) const override;
     uint64_t eval(Env&) const override;
 
 private:
@@ -98,11 +195,21 @@ public:
         , tag_(tag)
         , rhs_(std::move(rhs)) {}
 
+    ~BinExpr() override {
+        dispose(std::move(lhs_));
+        dispose(std::move(rhs_));
+    }
+
     const Expr* lhs() const { return lhs_.get(); }
     Tok::Tag tag() const { return tag_; }
     const Expr* rhs() const { return rhs_.get(); }
 
-    std::ostream& stream(std::ostream&) const override;
+    size_t num_ops() const override { return 2; }
+    const Expr* op(size_t i) const override { return i == 0 ? lhs() : rhs(); }
+    uint64_t fold(const uint64_t*) const override;
+    std::string_view glue(size_t) const override;
+
+    void write(std::string&) const override;
     uint64_t eval(Env&) const override;
 
 private:
@@ -117,7 +224,7 @@ public:
     ErrExpr(Loc loc)
         : Expr(loc) {}
 
-    std::ostream& stream(std::ostream&) const override;
+    void write(std::string&) const override;
     uint64_t eval(Env&) const override;
 };
 
@@ -131,7 +238,7 @@ public:
     Stmt(Loc loc)
         : Node(loc) {}
 
-    virtual void eval(Env&) const = 0;
+    virtual void eval(Env&, const Out&) const = 0;
 };
 
 class LetStmt : public Stmt {
@@ -144,8 +251,8 @@ public:
     Sym sym() const { return sym_; }
     const Expr* init() const { return init_.get(); }
 
-    std::ostream& stream(std::ostream&) const override;
-    void eval(Env&) const override;
+    void write(std::string&) const override;
+    void eval(Env&, const Out&) const override;
 
 private:
     Sym sym_;
@@ -160,8 +267,8 @@ public:
 
     const Expr* expr() const { return expr_.get(); }
 
-    std::ostream& stream(std::ostream&) const override;
-    void eval(Env&) const override;
+    void write(std::string&) const override;
+    void eval(Env&, const Out&) const override;
 
 private:
     AST<Expr> expr_;
@@ -177,10 +284,19 @@ public:
         : Node(loc)
         , stmts_(std::move(stmts)) {}
 
+    /// Below this many Stmt%s per thread, Prog::dump won't spawn another thread.
+    static constexpr size_t Min_Stmts_Per_Thread = 4096;
+
     const ASTs<Stmt>& stmts() const { return stmts_; }
 
-    std::ostream& stream(std::ostream&) const override;
-    void eval() const;
+    void write(std::string&) const override;
+    using Node::dump;
+    void dump(size_t num_threads) const; ///< Same as Node::dump but formats on up to @p num_threads threads.
+    void eval() const; ///< Evaluates in an empty Env and prints to `std::cout`.
+    void eval(Env&, const Out&) const;
+    /// Same as Prog::eval but only computes the bindings a PrintStmt needs - and each of them at most once.
+    /// The bindings in @p init are visible from the start.
+    void eval_lazy(const Env& init, const Out&) const;
 
 private:
     ASTs<Stmt> stmts_;
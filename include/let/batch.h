@@ -0,0 +1,65 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <filesystem>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "let/driver.h"
+
+namespace let {
+
+/// Processes many input files on a pool of threads.
+/// Each input gets its own Driver so that its memory - the AST and the interned Sym%s - is freed as soon as the input
+/// is done; only the Lexer's immutable keyword table is shared.
+/// The output and diagnostics of each file are collected and emitted in input order.
+class Batch {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    struct Options {
+        bool dump         = false;
+        bool eval         = false;
+        bool lazy         = false; ///< Implies Options::eval; see Prog::eval_lazy.
+        bool profile      = false; ///< Implies eager Options::eval - even with Options::lazy; reports to diag.
+        size_t max_errors = 0;     ///< Per file; see Driver::set_max_errors.
+        std::string folded;        ///< Write Profiler::folded here - only sensible for a single input.
+    };
+
+    Batch(std::vector<std::filesystem::path>&& inputs, Options opts)
+        : inputs_(std::move(inputs))
+        , opts_(std::move(opts)) {}
+
+    const std::vector<std::filesystem::path>& inputs() const { return inputs_; }
+
+    /// Processes all inputs on up to @p num_threads threads and writes the results of each input to @p out and its
+    /// diagnostics to @p err - in input order.
+    /// @returns whether all inputs were processed without errors.
+    bool run(size_t num_threads, std::ostream& out, std::ostream& err);
+
+    /// Time spent on each input during Batch::run.
+    void timing(std::ostream&) const;
+
+private:
+    struct Result {
+        std::string out, diag;
+        Clock::duration time = {};
+        bool ok              = false;
+        bool done            = false; // guarded by mutex_
+    };
+
+    void process(size_t i);
+
+    std::vector<std::filesystem::path> inputs_;
+    Options opts_;
+    std::vector<Result> results_;
+    Clock::duration wall_ = {};
+    size_t num_threads_   = 0;
+    std::mutex mutex_;
+    std::condition_variable done_;
+};
+
+} // namespace let
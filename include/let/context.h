@@ -0,0 +1,63 @@
+#pragma once
+
+#include <filesystem>
+#include <memory>
+#include <span>
+#include <string_view>
+#include <unordered_map>
+
+#include "let/ast.h"
+#include "let/driver.h"
+
+namespace let {
+
+/// Initial value of a variable for Program::run; like identifiers in let, Binding::name is case-insensitive.
+struct Binding {
+    std::string_view name;
+    uint64_t value;
+};
+
+/// A compiled let program that can be run any number of times - also concurrently.
+/// It lives in the memory of the Context that compiled it and must not outlive it.
+class Program {
+public:
+    const Prog& prog() const { return *prog_; }
+
+    /// Evaluates the program with the variables initialized to @p bindings and passes each printed value to @p out.
+    /// Unset variables are `0` as usual; bindings for names the program does not mention are ignored.
+    void run(std::span<const Binding> bindings, const Out& out) const;
+    /// Same as Program::run but via Prog::eval_lazy.
+    void run_lazy(std::span<const Binding> bindings, const Out& out) const;
+    /// The Env that Program::run starts with - for driving Prog or a Profiler yourself.
+    Env bind(std::span<const Binding> bindings) const;
+
+private:
+    Program(std::unique_ptr<std::filesystem::path>&& path, AST<Prog>&& prog);
+
+    std::unique_ptr<std::filesystem::path> path_; // Loc%s point to it
+    AST<Prog> prog_;
+    std::unordered_map<std::string_view, Sym> syms_; // all names read by prog_
+
+    friend class Context;
+};
+
+/// Entry point for embedding let: Create one Context and Context::compile your sources once.
+/// The Context owns the memory of all its Program%s and their interned names - hence, it only grows.
+/// Context::compile is not thread-safe.
+class Context {
+public:
+    Context() = default;
+    Context(const Context&) = delete;
+
+    Driver& driver() { return driver_; }
+
+    /// Compiles the source code @p src; @p name is used in diagnostics.
+    /// Diagnostics go to Driver::diag; throws `std::invalid_argument` if there were any errors.
+    /// Each call has its own budget of Driver::max_errors.
+    Program compile(std::string_view src, std::string_view name = "<buffer>");
+
+private:
+    Driver driver_;
+};
+
+} // namespace let
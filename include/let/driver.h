@@ -1,8 +1,12 @@
 #pragma once
 
+#include <ostream>
+
 #include <fe/arena.h>
 #include <fe/driver.h>
 
+#include "let/tok.h"
+
 namespace let {
 
 class Driver : public fe::Driver {
@@ -12,8 +16,35 @@ public:
         return arena_.mk<const T>(std::forward<Args&&>(args)...);
     }
 
+    /// @name Diagnostics
+    /// Unlike fe::Driver, this one reports to Driver::diag - `std::cerr` by default.
+    /// This allows to collect the diagnostics of Driver%s that run concurrently.
+    ///@{
+    std::ostream& diag() { return *diag_; }
+    void set_diag(std::ostream& diag) { diag_ = &diag; }
+    template<class... Args> void err(Loc loc, std::format_string<Args...> fmt, Args&&... args) {
+        ++num_errors_;
+        *diag_ << loc << ": error: " << std::format(fmt, std::forward<Args>(args)...) << std::endl;
+    }
+    unsigned num_errors() const { return num_errors_; }
+    ///@}
+
+    /// @name Error Limit
+    ///@{
+    size_t max_errors() const { return max_errors_; }
+    void set_max_errors(size_t max_errors) { max_errors_ = max_errors; } ///< `0` means unlimited.
+    /// Gives the next input its own budget of Driver::max_errors.
+    void reset_error_limit() { error_base_ = num_errors_; }
+    /// Once Driver::max_errors are reported for the current input, Lexer and Parser wind down as if the input ended.
+    bool gave_up() const { return max_errors_ != 0 && num_errors_ - error_base_ >= max_errors_; }
+    ///@}
+
 private:
     fe::Arena arena_;
+    std::ostream* diag_ = &std::cerr;
+    unsigned num_errors_ = 0;
+    unsigned error_base_ = 0; // Driver::num_errors before the current input
+    size_t max_errors_ = 0;
 };
 
 } // namespace let
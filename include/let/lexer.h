@@ -22,7 +22,6 @@ private:
     void eat_comments();
 
     Driver& driver_;
-    fe::SymMap<Tok::Tag> keywords_;
 };
 
 } // namespace let
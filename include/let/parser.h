@@ -25,14 +25,15 @@ private:
 
     Sym parse_sym(std::string_view ctxt = {});
 
-    AST<Expr> parse_expr(std::string_view ctxt, Tok::Prec = Tok::Prec::Bottom);
-    AST<Expr> parse_primary_or_unary_expr(std::string_view ctxt);
+    AST<Expr> parse_expr(std::string_view ctxt);
+    AST<Expr> parse_primary_expr(std::string_view ctxt);
 
     AST<Stmt> parse_let_stmt();
     AST<Stmt> parse_print_stmt();
 
     /// Issue an error message of the form:
     /// `expected <what>, got '<tok>' while parsing <ctxt>`
+    /// and enter panic mode: Further errors are suppressed until Parser::sync or Parser::expect_semicolon.
     void err(const std::string& what, const Tok& tok, std::string_view ctxt);
 
     /// Same above but uses Parser::ahead() as Tok%en.
@@ -40,8 +41,14 @@ private:
 
     void syntax_err(Tok::Tag tag, std::string_view ctxt);
 
+    /// Panic-mode recovery: Skips Tok%ens up to and including the next `;` or up to the next keyword.
+    void sync();
+    /// Expects the `;` that ends a Stmt%ement; if it's there, panic mode ends without Parser::sync.
+    void expect_semicolon(std::string_view ctxt);
+
     Lexer lexer_;
     Sym error_;
+    bool panic_ = false;
 
     friend class fe::Parser<Tok, Tok::Tag, 1, Parser>;
 };
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <ostream>
+#include <vector>
+
+#include "let/ast.h"
+
+namespace let {
+
+/// Sampling profiler for Prog::eval.
+/// Operation counts are exact; time is attributed to the Stmt and the Expr subtrees under evaluation whenever a sampler
+/// thread ticks - which only costs a relaxed atomic load per Expr as long as it doesn't.
+class Profiler {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    static constexpr std::chrono::nanoseconds Default_Interval = std::chrono::microseconds(100);
+    /// Deeper Expr%essions are attributed to their ancestor at this depth.
+    static constexpr size_t Max_Frames = 64;
+
+    Profiler(const Prog& prog, std::chrono::nanoseconds interval = Default_Interval);
+
+    /// Same as Prog::eval but records a profile; further calls accumulate.
+    void eval(Env&, const Out&);
+
+    /// Hottest @p max_stmts Stmt%s with their time, operations, and variable reads.
+    void report(std::ostream&, size_t max_stmts = 20) const;
+    /// One line `<stmt>;<expr>;...;<expr> <ns>` per sampled call stack - as expected by `flamegraph.pl`.
+    void folded(std::ostream&) const;
+
+private:
+    struct Stats {
+        uint64_t ns    = 0; // sampled
+        uint64_t ops   = 0; // evaluated UnaryExpr%s and BinExpr%s
+        uint64_t reads = 0; // evaluated SymExpr%s
+    };
+    uint64_t eval(const Expr*, Env&, Stats&);
+    uint64_t eval_nested(const Expr*, Env&, Stats&);
+    void sample(size_t stmt);
+
+    const Prog& prog_;
+    std::chrono::nanoseconds interval_;
+    std::vector<Stats> stats_; // per Stmt
+    std::map<std::vector<const Node*>, uint64_t> stacks_;
+    std::vector<Expr::Frame> todo_; // i, n, and args are only used by Expr::fold_nested
+    std::atomic<bool> tick_ = false;
+    Clock::time_point last_;
+    uint64_t total_ns_ = 0, num_samples_ = 0;
+};
+
+} // namespace let
@@ -0,0 +1,344 @@
+/// Differential fuzzer: Generates well-formed let programs along with their expected output and checks that every
+/// engine agrees. Build with `-DLET_BUILD_FUZZ=ON` (and `-DLET_LIBFUZZER=ON` with clang for a libFuzzer target).
+
+#include <cstdlib>
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "let/context.h"
+#include "let/profiler.h"
+
+using namespace std::literals;
+
+namespace {
+
+using Output = std::vector<uint64_t>;
+using Clock  = std::chrono::steady_clock;
+
+/*
+ * Gen
+ */
+
+/// Turns a byte string into a well-formed let program and computes its expected Output on the fly.
+/// Running out of bytes picks the first choice - which always leads towards termination.
+class Gen {
+public:
+    Gen(const uint8_t* data, size_t size)
+        : data_(data)
+        , size_(size) {}
+
+    std::string prog() {
+        for (size_t i = 0, e = pick(4); i != e; ++i) {
+            auto x = name();
+            auto u = u64();
+            bindings_.push_back({x, u});
+            env_[lower(x)] = u;
+        }
+
+        std::string src;
+        for (size_t i = 0, e = 1 + pick(32); i != e && !done(); ++i) stmt(src);
+        return src;
+    }
+
+    /// Initial values in arbitrary case for Program::run.
+    const std::vector<let::Binding>& bindings() const { return bindings_; }
+    const Output& expected() const { return expected_; }
+
+private:
+    enum Prec { Add, Mul, Unary, Primary }; // see Tok::Prec
+
+    struct Expr {
+        std::string src;
+        uint64_t val;
+        Prec prec;
+    };
+
+    bool done() const { return pos_ == size_; }
+    size_t pick(size_t n) { return done() ? 0 : data_[pos_++] % n; }
+    bool coin(size_t n) { return pick(n) == n - 1; } ///< `true` with a chance of `1/n`.
+
+    /// Keyword-free and case-insensitive: `x` and `X` are the same name.
+    std::string_view name() {
+        static constexpr std::string_view names[] = {"x", "y", "z", "X", "foo", "FoO", "_t", "n0", "unbound"};
+        return names[pick(std::size(names))];
+    }
+
+    static std::string lower(std::string_view s) {
+        std::string res(s);
+        std::ranges::transform(res, res.begin(), [](char c) { return std::tolower(c); });
+        return res;
+    }
+
+    uint64_t u64() {
+        static constexpr uint64_t lits[]
+            = {0, 1, 2, 3, 7, 10, 255, 4294967296, 9223372036854775808ull, 18446744073709551615ull};
+        if (coin(4)) {
+            uint64_t u = 0;
+            for (int i = 0; i != 8; ++i) u = u << 8 | pick(256);
+            return u;
+        }
+        return lits[pick(std::size(lits))];
+    }
+
+    void ws(std::string& src) {
+        switch (pick(8)) {
+            case 1: src += "  "; break;
+            case 2: src += '\n'; break;
+            case 3: src += "/* c */"; break;
+            case 4: src += "// c\n"; break;
+            default: src += ' ';
+        }
+    }
+
+    void stmt(std::string& src) {
+        switch (pick(6)) {
+            case 0: {
+                auto e = expr(0);
+                src.append("print ").append(e.src).append(";");
+                expected_.push_back(e.val);
+                break;
+            }
+            case 1: src += ";"; break;
+            case 2: {
+                auto e = deep();
+                src.append("print ").append(e.src).append(";");
+                expected_.push_back(e.val);
+                break;
+            }
+            default: {
+                auto x = name();
+                auto e = expr(0);
+                src.append("let ").append(x).append(" =");
+                ws(src);
+                src.append(e.src).append(";");
+                env_[lower(x)] = e.val;
+            }
+        }
+        ws(src);
+    }
+
+    Expr primary() {
+        if (coin(2)) {
+            auto x = name();
+            return {std::string(x), env_.emplace(lower(x), 0).first->second, Primary};
+        }
+        auto u = u64();
+        return {std::to_string(u), u, Primary};
+    }
+
+    static std::string paren(const Expr& e) { return "(" + e.src + ")"; }
+
+    Expr expr(int depth) {
+        if (depth == 6) return primary();
+        switch (pick(8)) {
+            case 0:
+            case 1: return primary();
+            case 2: {
+                auto e = expr(depth + 1);
+                return {paren(e), e.val, Primary};
+            }
+            case 3: {
+                auto e   = expr(depth + 1);
+                auto neg = !coin(4);
+                auto src = std::string(neg ? "-" : "+") + (e.prec < Unary ? paren(e) : e.src);
+                return {std::move(src), neg ? -e.val : e.val, Unary};
+            }
+            default: {
+                auto l = expr(depth + 1);
+                auto r = coin(4) ? Expr{"0", 0, Primary} : expr(depth + 1); // make div by zero more likely
+                auto o = pick(4);
+                auto p = o < 2 ? Add : Mul;
+                // left associativity: only the right operand needs parentheses on the same level
+                auto src = (l.prec < p ? paren(l) : l.src) + "+-*/"[o] + (r.prec <= p ? paren(r) : r.src);
+                uint64_t val;
+                switch (o) {
+                    case 0: val = l.val + r.val; break;
+                    case 1: val = l.val - r.val; break;
+                    case 2: val = l.val * r.val; break;
+                    default: val = r.val ? l.val / r.val : 0;
+                }
+                return {std::move(src), val, p};
+            }
+        }
+    }
+
+    /// Nests beyond Expr::Max_Rec_Depth to exercise the work-list traversals.
+    Expr deep() {
+        auto n = let::Expr::Max_Rec_Depth + pick(4) * 256 + pick(256);
+        auto x = primary();
+        switch (pick(3)) {
+            case 0: { // - ... -x
+                std::string src(n, '-');
+                return {src + x.src, n % 2 ? -x.val : x.val, Unary};
+            }
+            case 1: { // x + 1 + ... + 1
+                std::string src = x.src;
+                for (size_t i = 0; i != n; ++i) src += "+1";
+                return {src, x.val + n, Add};
+            }
+            default: { // 1 - (1 - ( ... (1 - x)))
+                std::string src;
+                for (size_t i = 0; i != n; ++i) src += "1-(";
+                src += x.src + std::string(n, ')');
+                return {src, n % 2 ? 1 - x.val : x.val, Add};
+            }
+        }
+    }
+
+    const uint8_t* data_;
+    size_t size_, pos_ = 0;
+    std::vector<let::Binding> bindings_;
+    std::map<std::string, uint64_t> env_;
+    Output expected_;
+};
+
+/*
+ * Engines
+ */
+
+struct Engine {
+    std::string_view name;
+    Output (*run)(let::Context&, const let::Program&, std::span<const let::Binding>);
+    Clock::duration time = {};
+};
+
+Output collect(auto&& eval) {
+    Output out;
+    eval([&](uint64_t u) { out.push_back(u); });
+    return out;
+}
+
+Engine engines[] = {
+    {"eval", [](let::Context&, const let::Program& prog, std::span<const let::Binding> bindings) {
+         return collect([&](auto&& out) { prog.run(bindings, out); });
+     }},
+    {"lazy", [](let::Context&, const let::Program& prog, std::span<const let::Binding> bindings) {
+         return collect([&](auto&& out) { prog.run_lazy(bindings, out); });
+     }},
+    {"profile", [](let::Context&, const let::Program& prog, std::span<const let::Binding> bindings) {
+         return collect([&](auto&& out) {
+             auto profiler = let::Profiler(prog.prog());
+             auto env      = prog.bind(bindings);
+             profiler.eval(env, out);
+         });
+     }},
+    {"dump", [](let::Context& ctx, const let::Program& prog, std::span<const let::Binding> bindings) {
+         std::string src, again;
+         prog.prog().write(src);
+         auto reparsed = ctx.compile(src, "<dump>");
+         reparsed.prog().write(again);
+         if (src != again) throw std::logic_error("dump of dump differs");
+         return collect([&](auto&& out) { reparsed.run(bindings, out); });
+     }},
+};
+
+[[noreturn]] void mismatch(const Gen& gen, const std::string& src, std::string_view engine, const Output& got) {
+    auto print = [](const Output& out) {
+        for (auto u : out) std::cerr << ' ' << u;
+        std::cerr << std::endl;
+    };
+    std::cerr << "mismatch in engine '" << engine << "' for program:\n" << src << "\nbindings:";
+    for (auto [name, value] : gen.bindings()) std::cerr << ' ' << name << '=' << value;
+    std::cerr << "\nexpected:";
+    print(gen.expected());
+    std::cerr << "got:     ";
+    print(got);
+    std::abort();
+}
+
+void check(const uint8_t* data, size_t size) {
+    auto gen       = Gen(data, size);
+    auto src       = gen.prog();
+    auto ctx       = let::Context();
+    auto& expected = gen.expected();
+
+    std::string_view stage = "compile";
+    try {
+        auto prog = ctx.compile(src, "<fuzz>");
+        for (auto& engine : engines) {
+            stage      = engine.name;
+            auto start = Clock::now();
+            auto got   = engine.run(ctx, prog, gen.bindings());
+            engine.time += Clock::now() - start;
+            if (got != expected) mismatch(gen, src, engine.name, got);
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "error: " << e.what() << std::endl;
+        mismatch(gen, src, stage, {});
+    }
+}
+
+/// Time spent per engine - also relative to the first one.
+void report() {
+    auto base = engines[0].time.count() ? engines[0].time : Clock::duration(1);
+    std::cerr << std::fixed << std::setprecision(3);
+    for (auto& engine : engines) {
+        auto secs = std::chrono::duration<double>(engine.time).count();
+        auto rel  = double(engine.time.count()) / double(base.count());
+        std::cerr << std::setw(10) << engine.name << std::setw(12) << secs << " s" << std::setw(10) << rel << "x\n";
+    }
+}
+
+} // namespace
+
+#ifdef LET_LIBFUZZER
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size) {
+    static bool registered = std::atexit(report) == 0;
+    (void)registered;
+    check(data, size);
+    return 0;
+}
+#else
+int main(int argc, char** argv) {
+    try {
+        static const auto usage = "USAGE:\n"
+                                  "  let-fuzz [-?|-h|--help] [-n|--runs <n>] [-s|--seed <s>]\n"
+                                  "\n"
+                                  "OPTIONS, ARGUMENTS:\n"
+                                  "  -?, -h, --help\n"
+                                  "  -n, --runs <n>          Number of generated programs (default: 10000).\n"
+                                  "  -s, --seed <s>          Seed of the random number generator (default: 0).\n";
+        size_t runs   = 10000;
+        uint64_t seed = 0;
+
+        for (int i = 1; i < argc; ++i) {
+            if (argv[i] == "-?"s || argv[i] == "-h"s || argv[i] == "--help"s) {
+                std::cerr << usage;
+                return EXIT_SUCCESS;
+            } else if (argv[i] == "-n"s || argv[i] == "--runs"s) {
+                if (++i == argc) throw std::invalid_argument("missing number of runs for --runs");
+                runs = std::stoull(argv[i]);
+            } else if (argv[i] == "-s"s || argv[i] == "--seed"s) {
+                if (++i == argc) throw std::invalid_argument("missing seed for --seed");
+                seed = std::stoull(argv[i]);
+            } else {
+                throw std::invalid_argument("unknown argument: "s + argv[i]);
+            }
+        }
+
+        auto rng = std::mt19937_64(seed);
+        std::vector<uint8_t> data;
+        for (size_t run = 0; run != runs; ++run) {
+            data.resize(rng() % 4096);
+            for (auto& byte : data) byte = uint8_t(rng());
+            check(data.data(), data.size());
+        }
+
+        std::cerr << runs << " programs passed" << std::endl;
+        report();
+    } catch (const std::exception& e) {
+        std::cerr << "error: " << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
+#endif
@@ -0,0 +1,23 @@
+#include "let/ast.h"
+
+namespace let {
+
+/// Drains a work list of pending Expr%essions.
+/// As the recursion budget stays exhausted meanwhile, destroying one of them merely parks its operands in this very
+/// list via a nested call - so the call depth stays constant no matter how deeply the Expr%ession is nested.
+void Expr::dispose_nested(AST<Expr>&& expr) {
+    thread_local std::vector<AST<Expr>> todo;
+    thread_local bool draining = false;
+
+    todo.emplace_back(std::move(expr));
+    if (draining) return;
+
+    draining = true;
+    while (!todo.empty()) {
+        auto e = std::move(todo.back()); // ~e parks the operands of e in todo
+        todo.pop_back();
+    }
+    draining = false;
+}
+
+} // namespace let
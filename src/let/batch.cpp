@@ -0,0 +1,133 @@
+#include "let/batch.h"
+
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+
+#include "let/parser.h"
+#include "let/profiler.h"
+
+namespace let {
+
+bool Batch::run(size_t num_threads, std::ostream& out, std::ostream& err) {
+    auto n       = inputs_.size();
+    auto start   = Clock::now();
+    num_threads_ = std::clamp(num_threads, size_t(1), std::max(n, size_t(1)));
+    results_     = std::vector<Result>(n);
+
+    std::atomic<size_t> next = 0;
+    std::vector<std::thread> workers;
+    for (size_t t = 0; t != num_threads_; ++t)
+        workers.emplace_back([this, &next, n]() {
+            for (size_t i; (i = next.fetch_add(1, std::memory_order_relaxed)) < n;) {
+                process(i);
+                {
+                    std::lock_guard lock(mutex_);
+                    results_[i].done = true;
+                }
+                done_.notify_all();
+            }
+        });
+
+    // emit in input order while the workers go ahead
+    bool ok = true;
+    for (auto& res : results_) {
+        {
+            std::unique_lock lock(mutex_);
+            done_.wait(lock, [&res]() { return res.done; });
+        }
+        out.write(res.out.data(), res.out.size()).flush();
+        err.write(res.diag.data(), res.diag.size()).flush();
+        ok &= res.ok;
+        res.out  = {};
+        res.diag = {};
+    }
+
+    for (auto& worker : workers) worker.join();
+    wall_ = Clock::now() - start;
+    return ok;
+}
+
+void Batch::process(size_t i) {
+    auto& path  = inputs_[i];
+    auto& res   = results_[i];
+    auto start  = Clock::now();
+    auto diag   = std::ostringstream();
+    auto report = [&](auto&& what) { diag << "error: " << what << '\n'; };
+    Driver driver; // a fresh one frees the previous AST - a Driver's memory only grows
+    driver.set_diag(diag);
+    driver.set_max_errors(opts_.max_errors);
+
+    try {
+        auto ifs = std::ifstream(path);
+        if (!ifs) {
+            report(std::format("cannot read file \"{}\"", path.string()));
+        } else {
+            auto parser = Parser(driver, ifs, &path);
+            auto prog   = parser.parse_prog();
+
+            if (opts_.dump) prog->write(res.out);
+
+            if (auto num = driver.num_errors()) {
+                if (driver.gave_up()) diag << "too many errors; giving up\n";
+                diag << num << " error(s) encountered\n";
+            } else {
+                auto env = Env();
+                auto out = [&res](uint64_t u) {
+                    char str[21]; // enough for 2^64 - 1 and '\n'
+                    auto end = std::to_chars(str, str + sizeof(str), u).ptr;
+                    *end++   = '\n';
+                    res.out.append(str, end);
+                };
+
+                if (opts_.profile) {
+                    auto profiler = Profiler(*prog);
+                    profiler.eval(env, out);
+                    profiler.report(diag);
+                    if (!opts_.folded.empty()) {
+                        auto ofs = std::ofstream(opts_.folded);
+                        if (!ofs) throw std::runtime_error(std::format("cannot write file \"{}\"", opts_.folded));
+                        profiler.folded(ofs);
+                    }
+                } else if (opts_.lazy) {
+                    prog->eval_lazy(env, out);
+                } else if (opts_.eval) {
+                    prog->eval(env, out);
+                }
+                res.ok = true;
+            }
+        }
+    } catch (const std::exception& e) {
+        report(e.what());
+        res.ok = false;
+    }
+
+    res.diag = std::move(diag).str();
+    res.time = Clock::now() - start;
+}
+
+void Batch::timing(std::ostream& o) const {
+    auto ms = [](Clock::duration d) { return std::chrono::duration<double, std::milli>(d).count(); };
+
+    Clock::duration sum = {};
+    size_t failed       = 0;
+    auto flags          = o.flags();
+    o << std::fixed << std::setprecision(3);
+    o << std::setw(12) << "time (ms)" << "  status  input\n";
+    for (size_t i = 0, e = results_.size(); i != e; ++i) {
+        auto& res = results_[i];
+        sum += res.time;
+        failed += !res.ok;
+        o << std::setw(12) << ms(res.time) << (res.ok ? "  ok      " : "  FAILED  ") << inputs_[i].string() << '\n';
+    }
+    o << results_.size() << " input(s), " << failed << " failed; " << ms(sum) << " ms in total, " << ms(wall_)
+      << " ms wall time on " << num_threads_ << " thread(s)\n";
+    o.flags(flags);
+}
+
+} // namespace let
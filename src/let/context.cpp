@@ -0,0 +1,72 @@
+#include "let/context.h"
+
+#include <algorithm>
+#include <cctype>
+#include <sstream>
+#include <stdexcept>
+
+#include "let/parser.h"
+
+namespace let {
+
+/*
+ * Program
+ */
+
+Program::Program(std::unique_ptr<std::filesystem::path>&& path, AST<Prog>&& prog)
+    : path_(std::move(path))
+    , prog_(std::move(prog)) {
+    std::vector<const Expr*> todo; // no recursion: Expr%essions may nest arbitrarily deep
+    for (auto&& stmt : prog_->stmts()) {
+        if (auto let = stmt->isa<LetStmt>())
+            todo.push_back(let->init());
+        else
+            todo.push_back(stmt->as<PrintStmt>()->expr());
+
+        while (!todo.empty()) {
+            auto expr = todo.back();
+            todo.pop_back();
+            if (auto sym = expr->isa<SymExpr>()) syms_.emplace(*sym->sym(), sym->sym());
+            for (size_t i = 0, e = expr->num_ops(); i != e; ++i) todo.push_back(expr->op(i));
+        }
+    }
+}
+
+Env Program::bind(std::span<const Binding> bindings) const {
+    Env env;
+    std::string name;
+    for (auto [str, value] : bindings) {
+        name.assign(str); // identifiers are case-insensitive - see Lexer::lex
+        std::ranges::transform(name, name.begin(), [](unsigned char c) { return std::tolower(c); });
+        if (auto i = syms_.find(name); i != syms_.end()) env[i->second] = value;
+    }
+    return env;
+}
+
+void Program::run(std::span<const Binding> bindings, const Out& out) const {
+    auto env = bind(bindings);
+    prog_->eval(env, out);
+}
+
+void Program::run_lazy(std::span<const Binding> bindings, const Out& out) const {
+    prog_->eval_lazy(bind(bindings), out);
+}
+
+/*
+ * Context
+ */
+
+Program Context::compile(std::string_view src, std::string_view name) {
+    auto path   = std::make_unique<std::filesystem::path>(name);
+    auto is     = std::istringstream(std::string(src)); // libc++ lacks <spanstream>
+    auto num    = driver_.num_errors();
+    driver_.reset_error_limit();
+    auto parser = Parser(driver_, is, path.get());
+    auto prog   = parser.parse_prog();
+
+    if (auto n = driver_.num_errors() - num)
+        throw std::invalid_argument(std::format("{} error(s) encountered in \"{}\"", n, name));
+    return {std::move(path), std::move(prog)};
+}
+
+} // namespace let
@@ -1,3 +1,5 @@
+#include <iostream>
+
 #include <fe/assert.h>
 
 #include "let/ast.h"
@@ -16,9 +18,36 @@ uint64_t LitExpr::eval(Env&) const { return u64(); }
 uint64_t SymExpr::eval(Env& env) const { return env.emplace(sym(), 0).first->second;}
 // clang-format on
 
+namespace {
+thread_local size_t depth = 0; // current recursion depth of Expr::eval
+}
+
+uint64_t UnaryExpr::eval(Env& env) const {
+    if (depth == Max_Rec_Depth) return eval_nested(env);
+    ++depth;
+    uint64_t args[] = {rhs()->eval(env)};
+    --depth;
+    return UnaryExpr::fold(args);
+}
+
 uint64_t BinExpr::eval(Env& env) const {
-    auto l = lhs()->eval(env);
-    auto r = rhs()->eval(env);
+    if (depth == Max_Rec_Depth) return eval_nested(env);
+    ++depth;
+    uint64_t args[] = {lhs()->eval(env), rhs()->eval(env)};
+    --depth;
+    return BinExpr::fold(args);
+}
+
+uint64_t UnaryExpr::fold(const uint64_t* args) const {
+    switch (tag()) {
+        case Tag::O_add: return args[0];
+        case Tag::O_sub: return -args[0];
+        default: fe::unreachable();
+    }
+}
+
+uint64_t BinExpr::fold(const uint64_t* args) const {
+    auto l = args[0], r = args[1];
     switch (tag()) {
         case Tag::O_add: return l + r;
         case Tag::O_sub: return l - r;
@@ -28,29 +57,31 @@ uint64_t BinExpr::eval(Env& env) const {
     }
 }
 
-uint64_t UnaryExpr::eval(Env& env) const {
-    auto r = rhs()->eval(env);
-    switch (tag()) {
-        case Tag::O_add: return r;
-        case Tag::O_sub: return -r;
-        default: fe::unreachable();
-    }
+/// Does not recurse into UnaryExpr::eval or BinExpr::eval; leaves are evaluated right away.
+/// The work list is shared per thread - so evaluating a typical statement does not allocate.
+uint64_t Expr::eval_nested(Env& env) const {
+    thread_local std::vector<Frame> todo;
+    return fold_nested(this, todo, [&env](const Expr* leaf) { return leaf->eval(env); }, [](const Expr*) {});
 }
 
 /*
  * Stmt
  */
 
-void LetStmt::eval(Env& env) const {
+void LetStmt::eval(Env& env, const Out&) const {
     auto i     = init()->eval(env);
     env[sym()] = i;
 }
 
-void PrintStmt::eval(Env& env) const { std::cout << expr()->eval(env) << std::endl; }
+void PrintStmt::eval(Env& env, const Out& out) const { out(expr()->eval(env)); }
 
 void Prog::eval() const {
     Env env;
-    for (auto&& stmt : stmts()) stmt->eval(env);
+    eval(env, [](uint64_t u) { std::cout << u << std::endl; });
+}
+
+void Prog::eval(Env& env, const Out& out) const {
+    for (auto&& stmt : stmts()) stmt->eval(env, out);
 }
 
 } // namespace let
@@ -0,0 +1,107 @@
+#include <algorithm>
+#include <cassert>
+#include <deque>
+
+#include "let/ast.h"
+
+namespace let {
+
+namespace {
+
+/// The deferred initialization of the LetStmt at Thunk::idx.
+struct Thunk {
+    size_t idx;
+    const Expr* expr;
+    uint64_t val = 0;
+    enum { Fresh, Pending, Done } state = Fresh;
+};
+
+} // namespace
+
+/// Thunk%s are forced with explicit work lists - chains of Thunk%s may be as long as the program.
+/// A Thunk reads the binding of a name that was visible at its LetStmt: the last Thunk of this name before it or,
+/// failing that, the value from @p init or 0 - just like Prog::eval.
+void Prog::eval_lazy(const Env& init, const Out& out) const {
+    struct Dep {
+        Sym sym;            // Sym() marks the beginning of the Dep%s of a Pending Thunk
+        const Thunk* thunk; // nullptr: from init or 0
+    };
+
+    std::deque<Thunk> thunks;
+    fe::SymMap<std::vector<Thunk*>> bindings; // per name in program order
+    std::vector<Thunk*> todo;
+    std::vector<Dep> deps; // of all Pending Thunk%s in todo - in the same order
+    std::vector<const Expr*> walk;
+    std::vector<Expr::Frame> frames;
+    Env none; // leaves other than SymExpr don't read the Env
+
+    auto lookup = [&](Sym sym, size_t idx) -> Thunk* {
+        auto i = bindings.find(sym);
+        if (i == bindings.end()) return nullptr;
+        auto& ts = i->second;
+        if (ts.back()->idx < idx) return ts.back(); // common case
+        auto j = std::ranges::lower_bound(ts, idx, {}, &Thunk::idx); // first Thunk not before idx
+        return j == ts.begin() ? nullptr : *(j - 1);
+    };
+
+    // Pushes the Dep%s of t in right-to-left order of its SymExpr%s and schedules those not yet Done.
+    auto resolve = [&](Thunk* t) {
+        deps.push_back({Sym(), t});
+        walk.push_back(t->expr);
+        while (!walk.empty()) {
+            auto expr = walk.back();
+            walk.pop_back();
+            if (auto n = expr->num_ops()) {
+                for (size_t i = 0; i != n; ++i) walk.push_back(expr->op(i));
+            } else if (expr->isa<SymExpr>()) {
+                auto sym = expr->as<SymExpr>()->sym();
+                auto dep = lookup(sym, t->idx);
+                deps.push_back({sym, dep});
+                if (dep && dep->state != Thunk::Done) todo.push_back(dep);
+            }
+        }
+    };
+
+    // Expr::fold_nested visits the leaves left-to-right and, thus, pops the Dep%s of a Pending Thunk in resolve order.
+    auto leaf = [&](const Expr* expr) -> uint64_t {
+        if (!expr->isa<SymExpr>()) return expr->eval(none);
+        auto [sym, dep] = deps.back();
+        deps.pop_back();
+        if (dep) return dep->val;
+        auto i = init.find(sym);
+        return i != init.end() ? i->second : 0;
+    };
+    auto eval = [&](const Expr* expr) { return Expr::fold_nested(expr, frames, leaf, [](const Expr*) {}); };
+
+    auto force = [&](Thunk* thunk) {
+        todo.push_back(thunk);
+        while (!todo.empty()) {
+            auto t = todo.back();
+            if (t->state == Thunk::Fresh) {
+                t->state = Thunk::Pending;
+                resolve(t);
+                continue;
+            }
+            if (t->state == Thunk::Pending) {
+                // all Dep%s of t are Done now and - as they were above t in todo - t's Dep%s are on top of deps
+                t->val = eval(t->expr);
+                assert(!deps.back().sym && deps.back().thunk == t);
+                deps.pop_back();
+                t->state = Thunk::Done;
+            }
+            todo.pop_back();
+        }
+        return thunk->val;
+    };
+
+    for (size_t i = 0, e = stmts().size(); i != e; ++i) {
+        if (auto let = stmts()[i]->isa<LetStmt>()) {
+            bindings[let->sym()].push_back(&thunks.emplace_back(i, let->init()));
+        } else {
+            auto print = Thunk(i, stmts()[i]->as<PrintStmt>()->expr());
+            out(force(&print));
+        }
+    }
+}
+
+} // namespace let
@@ -1,5 +1,8 @@
 #include "let/lexer.h"
 
+#include <string_view>
+#include <unordered_map>
+
 #include <fe/loc.cpp.h>
 
 using namespace std::literals;
@@ -8,19 +11,41 @@ namespace let {
 
 namespace utf8 = fe::utf8;
 
+namespace {
+/// Immutable and, hence, shared by all Lexer%s - also across threads.
+const std::unordered_map<std::string_view, Tok::Tag> keywords = {
+#define CODE(t, str) {str, Tok::Tag::t},
+    LET_KEY(CODE)
+#undef CODE
+};
+
+/// Can @p c start a Tok%en, whitespace, or a comment? Keep in sync with Lexer::lex.
+bool is_start(char32_t c) {
+    switch (c) {
+        case '(':
+        case ')':
+        case '=':
+        case ';':
+        case '+':
+        case '-':
+        case '*':
+        case '/': return true;
+        default: return c == utf8::EoF || c == '_' || utf8::isspace(c) || utf8::isdigit(c) || utf8::isalpha(c);
+    }
+}
+} // namespace
+
 Lexer::Lexer(Driver& driver, std::istream& istream, const std::filesystem::path* path)
     : fe::Lexer<1, Lexer>(istream, path)
     , driver_(driver) {
-    if (!istream_) throw std::runtime_error("stream is bad");
-#define CODE(t, str) keywords_[driver_.sym(str)] = Tok::Tag::t;
-    LET_KEY(CODE)
-#undef CODE
+    if (istream_.bad()) throw std::runtime_error("stream is bad"); // an empty stream already hit EoF
 }
 
 Tok Lexer::lex() {
     while (true) {
         start();
 
+        if (driver_.gave_up()) return {loc_, Tok::Tag::EoF};
         if (accept(utf8::EoF)) return {loc_, Tok::Tag::EoF};
         if (accept(utf8::isspace)) continue;
         if (accept('(')) return {loc_, Tok::Tag::D_paren_l};
@@ -54,18 +79,19 @@ Tok Lexer::lex() {
         if (accept<Append::Lower>([](char32_t c) { return c == '_' || utf8::isalpha(c); })) {
             while (accept<Append::Lower>([](char32_t c) { return c == '_' || utf8::isalpha(c) || utf8::isdigit(c); })) {
             }
-            auto sym = driver_.sym(str_);
-            if (auto i = keywords_.find(sym); i != keywords_.end()) return {loc_, i->second}; // keyword
-            return {loc_, sym};                                                               // identifier
+            if (auto i = keywords.find(str_); i != keywords.end()) return {loc_, i->second}; // keyword
+            return {loc_, driver_.sym(str_)};                                                 // identifier
         }
 
-        if (accept(utf8::Invalid)) {
-            driver().err(loc_, "invalid UTF-8 character");
-            continue;
-        }
-
-        driver().err({loc_.path, peek_}, "invalid input char: '{}'", utf8::Char32(ahead()));
-        next();
+        // coalesce a run of invalid chars into a single diagnostic
+        auto c   = next();
+        size_t n = 0;
+        for (; !is_start(ahead()); ++n) next();
+        auto more = n == 0 ? std::string() : std::format(" (followed by {} more invalid char(s))", n);
+        if (c == utf8::Invalid)
+            driver().err(loc_, "invalid UTF-8 character{}", more);
+        else
+            driver().err(loc_, "invalid input char: '{}'{}", utf8::Char32(c), more);
     }
 }
 
@@ -15,9 +15,24 @@ Parser::Parser(Driver& driver, std::istream& istream, const std::filesystem::pat
 }
 
 void Parser::err(const std::string& what, const Tok& tok, std::string_view ctxt) {
+    if (panic_ || driver().gave_up()) return; // follow-up errors until Parser::sync are most likely bogus
+    panic_ = true;
     driver().err(tok.loc(), "expected {}, got '{}' while parsing {}", what, tok, ctxt);
 }
 
+void Parser::sync() {
+    while (!ahead().isa(Tag::EoF) && !ahead().isa_key())
+        if (lex().isa(Tag::T_semicolon)) break;
+    panic_ = false;
+}
+
+void Parser::expect_semicolon(std::string_view ctxt) {
+    if (accept(Tag::T_semicolon))
+        panic_ = false; // the broken Stmt ended as usual - what follows is the next one
+    else
+        syntax_err(Tag::T_semicolon, ctxt);
+}
+
 void Parser::syntax_err(Tag tag, std::string_view ctxt) {
     std::string msg("'");
     msg.append(Tok::str(tag)).append("'");
@@ -34,46 +49,93 @@ Sym Parser::parse_sym(std::string_view ctxt) {
  * Expr
  */
 
-AST<Expr> Parser::parse_expr(std::string_view ctxt, Tok::Prec curr_prec) {
-    auto track = tracker();
-    auto lhs   = parse_primary_or_unary_expr(ctxt);
+/// Pratt parsing with explicit operand/operator stacks instead of recursion.
+/// An open parenthesis acts as a barrier on the operator stack that limits reductions to its inside.
+/// The stacks are shared per thread (see Expr::eval_nested) so parsing a typical Expr%ession does not allocate.
+AST<Expr> Parser::parse_expr(std::string_view ctxt) {
+    struct Opnd {
+        Pos begin; // includes surrounding parentheses and leading unary operators
+        AST<Expr> expr;
+    };
+    struct Optr {
+        Pos begin;
+        Tag tag; // Tag::D_paren_l for an open parenthesis
+        Tok::Prec prec;
+    };
+    thread_local std::vector<Opnd> opnds_tls;
+    thread_local std::vector<Optr> optrs_tls;
+    auto& opnds     = opnds_tls;
+    auto& optrs     = optrs_tls;
+    auto opnds_base = opnds.size();
+    auto optrs_base = optrs.size();
+
+    auto loc    = [&](Pos begin) { return Loc(prev_.path, begin, prev_.finis); };
+    auto reduce = [&]() {
+        auto optr = optrs.back();
+        optrs.pop_back();
+        auto rhs = std::move(opnds.back().expr);
+        opnds.pop_back();
+        if (optr.prec == Tok::Prec::Unary) {
+            opnds.push_back({optr.begin, ast<UnaryExpr>(loc(optr.begin), optr.tag, std::move(rhs))});
+        } else {
+            auto& lhs = opnds.back();
+            lhs.expr  = ast<BinExpr>(loc(lhs.begin), std::move(lhs.expr), optr.tag, std::move(rhs));
+        }
+    };
 
     while (true) {
-        auto prec = Tok::bin_prec(ahead().tag());
-        if (prec <= curr_prec) break;
-        auto op  = lex().tag();
-        auto rhs = parse_expr("right-hand side of binary expression", prec);
-        lhs      = ast<BinExpr>(track, std::move(lhs), op, std::move(rhs));
+        // prefix: unary operators and open parentheses followed by a primary expression
+        while (true) {
+            auto begin = ahead().loc().begin;
+            auto tag   = ahead().tag();
+            if (tag == Tag::V_sym || tag == Tag::V_int) break;
+            if (auto prec = Tok::un_prec(tag); prec != Tok::Prec::Error) {
+                optrs.push_back({begin, lex().tag(), prec});
+                ctxt = "operand of unary expression";
+            } else if (accept(Tag::D_paren_l)) {
+                optrs.push_back({begin, Tag::D_paren_l, Tok::Prec::Bottom});
+                ctxt = "parenthesized expression";
+            } else {
+                break;
+            }
+        }
+        opnds.push_back({ahead().loc().begin, parse_primary_expr(ctxt)});
+
+        // infix: reduce all operators that bind at least as strong as the next binary operator (left associativity)
+        while (true) {
+            auto prec = Tok::bin_prec(ahead().tag());
+            while (optrs.size() != optrs_base && optrs.back().tag != Tag::D_paren_l && optrs.back().prec >= prec)
+                reduce();
+
+            if (prec > Tok::Prec::Bottom) {
+                optrs.push_back({ahead().loc().begin, lex().tag(), prec});
+                ctxt = "right-hand side of binary expression";
+                break;
+            }
+
+            if (optrs.size() == optrs_base) {
+                assert(opnds.size() == opnds_base + 1);
+                auto expr = std::move(opnds.back().expr);
+                opnds.pop_back();
+                return expr;
+            }
+
+            opnds.back().begin = optrs.back().begin; // the operand now starts at the open parenthesis
+            optrs.pop_back();
+            expect(Tag::D_paren_r, "parenthesized expression");
+        }
     }
-
-    return lhs;
 }
 
-AST<Expr> Parser::parse_primary_or_unary_expr(std::string_view ctxt) {
+AST<Expr> Parser::parse_primary_expr(std::string_view ctxt) {
     switch (ahead().tag()) {
         case Tag::V_sym: return ast<SymExpr>(lex());
         case Tag::V_int: return ast<LitExpr>(lex());
         default: break;
     }
 
-    auto track = tracker();
-    if (auto prec = Tok::un_prec(ahead().tag()); prec != Tok::Prec::Error) {
-        auto op = lex().tag();
-        return ast<UnaryExpr>(track, op, parse_expr("operand of unary expression", prec));
-    }
-
-    if (accept(Tag::D_paren_l)) {
-        auto expr = parse_expr("parenthesized expression");
-        expect(Tag::D_paren_r, "parenthesized expression");
-        return expr;
-    }
-
-    if (!ctxt.empty()) {
-        err("primary or unary expression", ctxt);
-        return ast<ErrExpr>(curr_);
-    }
-
-    fe::unreachable();
+    err("primary or unary expression", ctxt);
+    return ast<ErrExpr>(curr_);
 }
 
 /*
@@ -86,7 +148,7 @@ AST<Stmt> Parser::parse_let_stmt() {
     auto sym = parse_sym("name of a let-statement");
     expect(Tag::T_ass, "let-statement");
     auto init = parse_expr("initialization expression of a let-statement");
-    expect(Tag::T_semicolon, "let-statement");
+    expect_semicolon("let-statement");
     return ast<LetStmt>(track, sym, std::move(init));
 }
 
@@ -94,7 +156,7 @@ AST<Stmt> Parser::parse_print_stmt() {
     auto track = tracker();
     eat(Tag::K_print);
     auto expr = parse_expr("print-statement");
-    expect(Tag::T_semicolon, "print-statement");
+    expect_semicolon("print-statement");
     return ast<PrintStmt>(track, std::move(expr));
 }
 
@@ -106,15 +168,14 @@ AST<Prog> Parser::parse_prog() {
     auto track = tracker();
     ASTs<Stmt> stmts;
     while (true) {
+        if (panic_) sync();
         // clang-format off
         switch (ahead().tag()) {
             case Tag::T_semicolon: lex(); break; // empty statement
             case Tag::K_let:       stmts.emplace_back(parse_let_stmt());   break;
             case Tag::K_print:     stmts.emplace_back(parse_print_stmt()); break;
             case Tag::EoF:         return ast<Prog>(track, std::move(stmts));
-            default:
-                auto tok = lex();
-                driver().err(tok.loc(), "expected statement, got '{}' while parsing program", tok);
+            default:               err("statement", "program");
         }
         // clang-format on
     }
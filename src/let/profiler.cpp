@@ -0,0 +1,184 @@
+#include "let/profiler.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <numeric>
+#include <sstream>
+#include <thread>
+#include <tuple>
+
+namespace let {
+
+namespace {
+/// Frame name of @p node in a folded stack - must not contain `;`.
+void frame(std::ostream& o, const Node* node) {
+    if (auto let = node->isa<LetStmt>())
+        o << "let " << let->sym() << '@' << let->loc();
+    else if (node->isa<PrintStmt>())
+        o << "print@" << node->loc();
+    else if (auto un = node->isa<UnaryExpr>())
+        o << Tok::str(un->tag()) << "e@" << un->loc().begin << '-' << un->loc().finis;
+    else if (auto bin = node->isa<BinExpr>())
+        o << "e" << Tok::str(bin->tag()) << "e@" << bin->loc().begin << '-' << bin->loc().finis;
+    else
+        fe::unreachable();
+}
+
+/// Same as Stmt::write without the trailing newline but stops soon after @p max chars - Stmt%s may be huge.
+std::string prefix(const Stmt* stmt, size_t max) {
+    std::string buf;
+    if (auto let = stmt->isa<LetStmt>()) {
+        buf.append("let ").append(*let->sym()).append(" = ");
+        let->init()->write_prefix(buf, max);
+    } else {
+        buf.append("print ");
+        stmt->as<PrintStmt>()->expr()->write_prefix(buf, max);
+    }
+    buf.push_back(';');
+    return buf;
+}
+} // namespace
+
+Profiler::Profiler(const Prog& prog, std::chrono::nanoseconds interval)
+    : prog_(prog)
+    , interval_(interval)
+    , stats_(prog.stmts().size()) {}
+
+void Profiler::eval(Env& env, const Out& out) {
+    tick_.store(false, std::memory_order_relaxed);
+    auto start = last_ = Clock::now();
+    {
+        struct Sampler {
+            std::atomic<bool> stop = false;
+            std::thread thread;
+            ~Sampler() {
+                stop.store(true, std::memory_order_relaxed);
+                thread.join();
+            }
+        } sampler;
+        sampler.thread = std::thread([this, &stop = sampler.stop]() {
+            while (!stop.load(std::memory_order_relaxed)) {
+                std::this_thread::sleep_for(interval_);
+                tick_.store(true, std::memory_order_relaxed);
+            }
+        });
+
+        for (size_t i = 0, e = prog_.stmts().size(); i != e; ++i) {
+            auto stmt = prog_.stmts()[i].get();
+            if (auto let = stmt->isa<LetStmt>()) {
+                auto val        = eval(let->init(), env, stats_[i]);
+                env[let->sym()] = val;
+            } else {
+                out(eval(stmt->as<PrintStmt>()->expr(), env, stats_[i]));
+            }
+            // charge the rest - e.g. the output - to the Stmt itself
+            if (tick_.load(std::memory_order_relaxed)) [[unlikely]]
+                sample(i);
+        }
+    }
+    total_ns_ += std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count();
+}
+
+/// Mirrors Expr::eval but also pushes each UnaryExpr and BinExpr to Profiler::todo_ so Profiler::sample finds the
+/// current call stack there.
+uint64_t Profiler::eval(const Expr* expr, Env& env, Stats& stats) {
+    if (tick_.load(std::memory_order_relaxed)) [[unlikely]]
+        sample(size_t(&stats - stats_.data()));
+
+    auto n = expr->num_ops();
+    if (n == 0) {
+        if (expr->isa<SymExpr>()) ++stats.reads;
+        return expr->eval(env);
+    }
+    if (todo_.size() == Expr::Max_Rec_Depth) return eval_nested(expr, env, stats);
+
+    uint64_t args[2];
+    todo_.push_back({expr, 0, n, {}});
+    for (size_t i = 0; i != n; ++i) args[i] = eval(expr->op(i), env, stats);
+    todo_.pop_back();
+    ++stats.ops;
+    return expr->fold(args);
+}
+
+/// Same as Expr::eval_nested but on Profiler::todo_.
+uint64_t Profiler::eval_nested(const Expr* expr, Env& env, Stats& stats) {
+    auto stmt = size_t(&stats - stats_.data());
+    auto tick = [this, stmt]() {
+        if (tick_.load(std::memory_order_relaxed)) [[unlikely]]
+            sample(stmt);
+    };
+    auto leaf = [&](const Expr* sub) {
+        tick();
+        if (sub->isa<SymExpr>()) ++stats.reads;
+        return sub->eval(env);
+    };
+    return Expr::fold_nested(expr, todo_, leaf, [&](const Expr*) {
+        tick();
+        ++stats.ops;
+    });
+}
+
+void Profiler::sample(size_t stmt) {
+    tick_.store(false, std::memory_order_relaxed);
+    auto now = Clock::now();
+    auto ns  = uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(now - last_).count());
+    last_    = now;
+
+    std::vector<const Node*> stack;
+    stack.reserve(std::min(todo_.size() + 1, Max_Frames));
+    stack.push_back(prog_.stmts()[stmt].get());
+    for (size_t i = 0, e = std::min(todo_.size(), Max_Frames - 1); i != e; ++i) stack.push_back(todo_[i].expr);
+
+    stacks_[std::move(stack)] += ns;
+    stats_[stmt].ns += ns;
+    ++num_samples_;
+}
+
+void Profiler::report(std::ostream& o, size_t max_stmts) const {
+    Stats all;
+    for (auto& s : stats_) all.ops += s.ops, all.reads += s.reads;
+    auto ms = [](uint64_t ns) { return double(ns) / 1e6; };
+
+    std::vector<size_t> order(stats_.size());
+    std::iota(order.begin(), order.end(), 0);
+    auto key = [&](size_t i) { return std::tie(stats_[i].ns, stats_[i].ops, stats_[i].reads); };
+    std::ranges::stable_sort(order, [&](size_t i, size_t j) { return key(i) > key(j); });
+    order.resize(std::min(order.size(), max_stmts));
+
+    auto flags = o.flags();
+    o << std::fixed << std::setprecision(3);
+    o << "profile: " << ms(total_ns_) << " ms; " << num_samples_ << " samples; " << all.ops << " ops; " << all.reads
+      << " reads\n";
+    o << std::setw(12) << "time (ms)" << std::setw(8) << "%" << std::setw(14) << "ops" << std::setw(14) << "reads"
+      << "  statement\n";
+    for (auto i : order) {
+        auto& s    = stats_[i];
+        auto stmt  = prog_.stmts()[i].get();
+        auto share = total_ns_ ? 100. * double(s.ns) / double(total_ns_) : 0.;
+
+        auto text = prefix(stmt, 60);
+        if (text.size() > 60) text.replace(57, std::string::npos, "...");
+
+        o << std::setw(12) << ms(s.ns) << std::setw(8) << std::setprecision(1) << share << std::setprecision(3)
+          << std::setw(14) << s.ops << std::setw(14) << s.reads << "  " << stmt->loc() << ": " << text << '\n';
+    }
+    o.flags(flags);
+}
+
+void Profiler::folded(std::ostream& o) const {
+    std::vector<std::string> lines;
+    for (auto& [stack, ns] : stacks_) {
+        std::ostringstream line;
+        for (bool first = true; auto node : stack) {
+            if (!first) line << ';';
+            first = false;
+            frame(line, node);
+        }
+        line << ' ' << ns << '\n';
+        lines.emplace_back(line.str());
+    }
+    std::ranges::sort(lines);
+    for (auto& line : lines) o << line;
+}
+
+} // namespace let
@@ -1,58 +1,162 @@
+#include <algorithm>
+#include <charconv>
 #include <iostream>
+#include <thread>
+
+#include <fe/assert.h>
 
 #include "let/ast.h"
 
 namespace let {
 
+namespace {
+thread_local size_t depth = 0; // current recursion depth of Expr::write
+
+void write_u64(std::string& buf, uint64_t u) {
+    char str[20]; // enough for 2^64 - 1
+    auto res = std::to_chars(str, str + sizeof(str), u);
+    buf.append(str, res.ptr);
+}
+} // namespace
+
 // stream
 
-void Node::dump() const { stream(std::cout); }
+void Node::dump() const {
+    std::string buf;
+    write(buf);
+    std::cout.write(buf.data(), buf.size()).flush();
+}
+
+std::ostream& Node::stream(std::ostream& o) const {
+    std::string buf;
+    write(buf);
+    return o.write(buf.data(), buf.size());
+}
 
 /*
  * Expr
  */
 
 // clang-format off
-std::ostream& ErrExpr::stream(std::ostream& o) const { return o << "<error expression>"; }
-std::ostream& LitExpr::stream(std::ostream& o) const { return o << u64(); }
-std::ostream& SymExpr::stream(std::ostream& o) const { return o << sym(); }
+void ErrExpr::write(std::string& buf) const { buf.append("<error expression>"); }
+void LitExpr::write(std::string& buf) const { write_u64(buf, u64()); }
+void SymExpr::write(std::string& buf) const { buf.append(*sym()); }
 // clang-format on
 
-std::ostream& UnaryExpr::stream(std::ostream& o) const {
-    o << '(' << tag();
-    rhs()->stream(o);
-    return o << ')';
+void UnaryExpr::write(std::string& buf) const {
+    if (depth == Max_Rec_Depth) return write_nested(buf);
+    ++depth;
+    buf.append(UnaryExpr::glue(0));
+    rhs()->write(buf);
+    buf.append(UnaryExpr::glue(1));
+    --depth;
 }
 
-std::ostream& BinExpr::stream(std::ostream& o) const {
-    o << '(';
-    lhs()->stream(o);
-    o << ' ' << tag() << ' ';
-    rhs()->stream(o);
-    return o << ')';
+void BinExpr::write(std::string& buf) const {
+    if (depth == Max_Rec_Depth) return write_nested(buf);
+    ++depth;
+    buf.append(BinExpr::glue(0));
+    lhs()->write(buf);
+    buf.append(BinExpr::glue(1));
+    rhs()->write(buf);
+    buf.append(BinExpr::glue(2));
+    --depth;
+}
+
+std::string_view UnaryExpr::glue(size_t i) const {
+    static constexpr std::string_view open[] = {"(+", "(-"};
+    if (i != 0) return ")";
+    return open[tag() == Tok::Tag::O_sub];
+}
+
+std::string_view BinExpr::glue(size_t i) const {
+    if (i == 0) return "(";
+    if (i == 2) return ")";
+    switch (tag()) {
+#define CODE(t, str, _) \
+    case Tok::Tag::t: return " " str " ";
+        LET_OP(CODE)
+#undef CODE
+        default: fe::unreachable();
+    }
+}
+
+/// Pre-order traversal with an explicit work list; see Expr::eval_nested.
+/// The output is the same as the one of the recursive UnaryExpr::write and BinExpr::write - up to @p max chars.
+void Expr::write_nested(std::string& buf, size_t max) const {
+    struct Visit {
+        const Expr* expr;
+        size_t i; // next operand to visit
+    };
+    thread_local std::vector<Visit> todo;
+
+    auto base = todo.size();
+    todo.push_back({this, 0});
+    while (todo.size() != base && buf.size() <= max) {
+        auto [expr, i] = todo.back();
+        buf.append(expr->glue(i));
+        if (i == expr->num_ops()) {
+            todo.pop_back();
+            continue;
+        }
+
+        ++todo.back().i;
+        auto sub = expr->op(i);
+        if (sub->num_ops() == 0)
+            sub->write(buf);
+        else
+            todo.push_back({sub, 0});
+    }
+    todo.resize(base); // drop the rest beyond max
 }
 
 /*
  * Stmt
  */
 
-std::ostream& LetStmt::stream(std::ostream& o) const {
-    o << "let " << sym() << " = ";
-    return init()->stream(o) << ';' << std::endl;
+void LetStmt::write(std::string& buf) const {
+    buf.append("let ").append(*sym()).append(" = ");
+    init()->write(buf);
+    buf.append(";\n");
 }
 
-std::ostream& PrintStmt::stream(std::ostream& o) const {
-    o << "print ";
-    return expr()->stream(o) << ';' << std::endl;
+void PrintStmt::write(std::string& buf) const {
+    buf.append("print ");
+    expr()->write(buf);
+    buf.append(";\n");
 }
 
 /*
  * Prog
  */
 
-std::ostream& Prog::stream(std::ostream& o) const {
-    for (auto&& stmt : stmts()) stmt->stream(o);
-    return o;
+void Prog::write(std::string& buf) const {
+    for (auto&& stmt : stmts()) stmt->write(buf);
+}
+
+/// Each thread formats a contiguous range of Stmt%s into its own buffer; the buffers are glued in order afterwards.
+void Prog::dump(size_t num_threads) const {
+    auto n      = stmts().size();
+    num_threads = std::clamp(n / Min_Stmts_Per_Thread, size_t(1), std::max(num_threads, size_t(1)));
+    if (num_threads == 1) return Node::dump();
+
+    std::vector<std::string> bufs(num_threads);
+    {
+        std::vector<std::thread> threads;
+        for (size_t t = 0; t != num_threads; ++t)
+            threads.emplace_back([this, &bufs, n, num_threads, t]() {
+                for (size_t i = n * t / num_threads, e = n * (t + 1) / num_threads; i != e; ++i)
+                    stmts()[i]->write(bufs[t]);
+            });
+        for (auto& thread : threads) thread.join();
+    }
+
+    auto& buf   = bufs.front();
+    size_t size = 0;
+    for (auto& b : bufs) size += b.size();
+    buf.reserve(size);
+    for (size_t t = 1; t != num_threads; ++t) buf.append(bufs[t]);
+    std::cout.write(buf.data(), buf.size()).flush();
 }
 
 } // namespace let
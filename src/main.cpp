@@ -3,8 +3,11 @@
 #include <fstream>
 #include <iostream>
 #include <stdexcept>
+#include <thread>
 
+#include "let/batch.h"
 #include "let/parser.h"
+#include "let/profiler.h"
 
 using namespace std::literals;
 
@@ -12,7 +15,9 @@ int main(int argc, char** argv) {
     try {
         static const auto version = "let " LET_VERSION "\n";
         static const auto usage   = "USAGE:\n"
-                                    "  let [-?|-h|--help] [-v|--version] [-d|--dump] [-e|--eval] [<file>]\n"
+                                    "  let [-?|-h|--help] [-v|--version] [-d|--dump] [-e|--eval] "
+                                    "[-j|--jobs <n>] [--max-errors <n>] [-l|--lazy] [-p|--profile] [--folded <out>] "
+                                    "[-t|--timing] [<file>|@<list> ...]\n"
                                     "\n"
                                     "Display usage information.\n"
                                     ""
@@ -21,10 +26,27 @@ int main(int argc, char** argv) {
                                     "  -v, --version           Display version info and exit.\n"
                                     "  -d, --dump              Dumps the let program again.\n"
                                     "  -e, --eval              Evaluate the let program.\n"
-                                    "  <file>                  Input file.\n";
+                                    "  -j, --jobs <n>          Use up to <n> threads (0: all cores; default: 1).\n"
+                                    "  --max-errors <n>        Stop after <n> errors (0: never; default: 0).\n"
+                                    "  -l, --lazy              Evaluate lazily: "
+                                    "only compute bindings that are printed.\n"
+                                    "  -p, --profile           Evaluate and report the hottest statements to stderr.\n"
+                                    "  --folded <out>          Profile and write folded stacks "
+                                    "for flamegraph.pl to <out>.\n"
+                                    "  -t, --timing            Report the time spent on each input to stderr.\n"
+                                    "  <file>                  Input file; "
+                                    "several ones are processed on up to --jobs threads.\n"
+                                    "  @<list>                 Input files listed in <list> - one per line.\n";
         bool dump                 = false;
         bool eval                 = false;
-        std::string input;
+        size_t jobs               = 1;
+        size_t max_errors         = 0;
+        bool lazy                 = false;
+        bool profile              = false;
+        bool timing               = false;
+        bool batch                = false;
+        std::string folded;
+        std::vector<std::filesystem::path> inputs;
 
         for (int i = 1; i < argc; ++i) {
             if (argv[i] == "-v"s || argv[i] == "--version"s) {
@@ -37,29 +59,86 @@ int main(int argc, char** argv) {
                 dump = true;
             } else if (argv[i] == "-e"s || argv[i] == "--eval"s) {
                 eval = true;
+            } else if (argv[i] == "-j"s || argv[i] == "--jobs"s) {
+                if (++i == argc) throw std::invalid_argument("missing number of threads for --jobs");
+                jobs = std::stoul(argv[i]);
+                if (jobs == 0) jobs = std::max(std::thread::hardware_concurrency(), 1u);
+            } else if (argv[i] == "--max-errors"s) {
+                if (++i == argc) throw std::invalid_argument("missing number of errors for --max-errors");
+                max_errors = std::stoul(argv[i]);
+            } else if (argv[i] == "-l"s || argv[i] == "--lazy"s) {
+                lazy = true;
+            } else if (argv[i] == "-p"s || argv[i] == "--profile"s) {
+                profile = true;
+            } else if (argv[i] == "--folded"s) {
+                if (++i == argc) throw std::invalid_argument("missing output file for --folded");
+                folded  = argv[i];
+                profile = true;
+            } else if (argv[i] == "-t"s || argv[i] == "--timing"s) {
+                timing = true;
+            } else if (argv[i][0] == '@') {
+                auto list = std::ifstream(argv[i] + 1);
+                if (!list) throw std::runtime_error(std::format("cannot read file list \"{}\"", argv[i] + 1));
+                for (std::string line; std::getline(list, line);)
+                    if (!line.empty()) inputs.emplace_back(line);
+                batch = true;
             } else {
-                if (!input.empty()) throw std::invalid_argument("more than one input file given");
-                input = argv[i];
+                inputs.emplace_back(argv[i]);
             }
         }
 
-        if (input.empty()) throw std::invalid_argument("no input given");
+        if (inputs.empty()) throw std::invalid_argument("no input given");
+        if (profile && lazy) throw std::invalid_argument("--profile only supports eager evaluation; drop --lazy");
+        if (!folded.empty() && (batch || inputs.size() > 1))
+            throw std::invalid_argument("--folded requires a single input file");
+
+        if (batch || timing || inputs.size() > 1) {
+            auto opts = let::Batch::Options{.dump       = dump,
+                                            .eval       = eval,
+                                            .lazy       = lazy,
+                                            .profile    = profile,
+                                            .max_errors = max_errors,
+                                            .folded     = folded};
+            auto b  = let::Batch(std::move(inputs), opts);
+            auto ok = b.run(jobs, std::cout, std::cerr);
+            if (timing) b.timing(std::cerr);
+            return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+        }
+
+        auto input = inputs.front().string();
 
         auto driver = let::Driver();
+        driver.set_max_errors(max_errors);
         auto path   = std::filesystem::path(input);
         auto ifs    = std::ifstream(path);
         if (!ifs) throw std::runtime_error(std::format("cannot read file \"{}\"", input));
         auto parser = let::Parser(driver, ifs, &path);
         auto prog   = parser.parse_prog();
 
-        if (dump) prog->dump();
+        if (dump) prog->dump(jobs);
 
         if (auto num = driver.num_errors()) {
+            if (driver.gave_up()) std::cerr << "too many errors; giving up" << std::endl;
             std::cerr << num << " error(s) encountered" << std::endl;
             return EXIT_FAILURE;
         }
 
-        if (eval) prog->eval(); // only evaluate a well-formed program
+        // only evaluate a well-formed program
+        if (profile) {
+            auto profiler = let::Profiler(*prog);
+            auto env      = let::Env();
+            profiler.eval(env, [](uint64_t u) { std::cout << u << std::endl; });
+            profiler.report(std::cerr);
+            if (!folded.empty()) {
+                auto ofs = std::ofstream(folded);
+                if (!ofs) throw std::runtime_error(std::format("cannot write file \"{}\"", folded));
+                profiler.folded(ofs);
+            }
+        } else if (lazy) {
+            prog->eval_lazy({}, [](uint64_t u) { std::cout << u << std::endl; });
+        } else if (eval) {
+            prog->eval();
+        }
     } catch (const std::exception& e) {
         std::cerr << "error: " << e.what() << std::endl;
         return EXIT_FAILURE;
@@ -0,0 +1,125 @@
+/// Checks the embedding API of liblet - see "Embedding" in the README.
+
+#include <cstdlib>
+
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <let/context.h>
+
+namespace {
+
+using Output = std::vector<uint64_t>;
+
+int num_failed = 0;
+
+#define CHECK(cond) check(cond, #cond, __LINE__)
+void check(bool ok, const char* cond, int line) {
+    if (ok) return;
+    std::cerr << __FILE__ << ':' << line << ": check failed: " << cond << std::endl;
+    ++num_failed;
+}
+
+Output run(const let::Program& prog, std::span<const let::Binding> bindings) {
+    Output out;
+    prog.run(bindings, [&](uint64_t u) { out.push_back(u); });
+    return out;
+}
+
+Output run_lazy(const let::Program& prog, std::span<const let::Binding> bindings) {
+    Output out;
+    prog.run_lazy(bindings, [&](uint64_t u) { out.push_back(u); });
+    return out;
+}
+
+void readme() {
+    auto buf = std::ostringstream();
+    auto old = std::cout.rdbuf(buf.rdbuf());
+    {
+        let::Context ctx;                                             // owns all compiled programs
+        auto prog = ctx.compile("print x * x + y;");                  // throws std::invalid_argument on errors
+        let::Binding bindings[] = {{"x", 3}, {"y", 1}};               // unbound names are 0 as usual
+        prog.run(bindings, [](uint64_t u) { std::cout << u << '\n'; }); // prints 10
+    }
+    std::cout.rdbuf(old);
+    CHECK(buf.str() == "10\n");
+}
+
+/// Compile once, run many times with different bindings - names are case-insensitive.
+void run_many() {
+    let::Context ctx;
+    auto prog = ctx.compile("let y = Y + 1; print x * y; print X; let x = 7; print x + unset;");
+
+    let::Binding lower[] = {{"x", 2}, {"y", 3}};
+    let::Binding upper[] = {{"X", 5}, {"Y", 0}, {"Unknown", 1}};
+    let::Binding mixed[] = {{"x", 1}, {"X", 4}, {"yY", 9}}; // the last binding of a name wins
+
+    CHECK(run(prog, lower) == Output({8, 2, 7}));
+    CHECK(run(prog, upper) == Output({5, 5, 7}));
+    CHECK(run(prog, mixed) == Output({4, 4, 7}));
+    CHECK(run(prog, {}) == Output({0, 0, 7}));
+
+    for (auto bindings : {std::span<const let::Binding>(lower), std::span<const let::Binding>(upper),
+                          std::span<const let::Binding>(mixed), std::span<const let::Binding>()})
+        CHECK(run_lazy(prog, bindings) == run(prog, bindings));
+}
+
+void compile_errors() {
+    let::Context ctx;
+    auto diag = std::ostringstream();
+    ctx.driver().set_diag(diag);
+
+    bool thrown = false;
+    try {
+        ctx.compile("print ;", "broken.let");
+    } catch (const std::invalid_argument& e) {
+        thrown = std::string(e.what()).find("broken.let") != std::string::npos;
+    }
+    CHECK(thrown);
+    CHECK(diag.str().find("broken.let:1:7: error:") != std::string::npos);
+
+    // the Context is still usable
+    auto prog = ctx.compile("print 42;");
+    CHECK(run(prog, {}) == Output({42}));
+}
+
+/// Driver::max_errors applies to each Context::compile on its own - not to the Context's lifetime.
+void max_errors() {
+    let::Context ctx;
+    auto diag = std::ostringstream();
+    ctx.driver().set_diag(diag);
+    ctx.driver().set_max_errors(2);
+
+    for (int i = 0; i != 2; ++i) {
+        bool thrown = false;
+        try {
+            ctx.compile("print ;");
+        } catch (const std::invalid_argument&) {
+            thrown = true;
+        }
+        CHECK(thrown);
+    }
+
+    auto prog = ctx.compile("print 42;");
+    CHECK(prog.prog().stmts().size() == 1);
+    CHECK(run(prog, {}) == Output({42}));
+}
+
+} // namespace
+
+int main() {
+    readme();
+    run_many();
+    compile_errors();
+    max_errors();
+
+    if (num_failed != 0) {
+        std::cerr << num_failed << " check(s) failed" << std::endl;
+        return EXIT_FAILURE;
+    }
+    std::cout << "all checks passed" << std::endl;
+    return EXIT_SUCCESS;
+}
@@ -85,6 +85,143 @@ for letf in test/error/*.let; do
     fi
 done
 
+# Stress tests: the nesting depth is only bounded by the heap - not by the stack
+DEPTH=${STRESS_DEPTH:-10000000}
+stress_let=$(mktemp)
+stress_dump=$(mktemp)
+trap 'rm -f "$stdout_tmp" "$stderr_tmp" "$stress_let" "$stress_dump"' EXIT
+
+repeat() { yes "$1" | head -n "$2" | tr -d '\n'; }
+
+# stress <name> <expected stdout> <let args>...
+stress() {
+    local base=$1 expected=$2
+    shift 2
+    ((TOTAL++))
+    "$LET" "$@" > "$stdout_tmp" 2> "$stderr_tmp"
+    rc=$?
+    if [[ $rc -ne 0 ]]; then
+        red "FAIL: $base (exit code $rc)"
+        head -c 1000 "$stderr_tmp" | sed 's/^/  /'
+        ((FAIL++))
+    elif [[ "$(cat "$stdout_tmp")" != "$expected" ]]; then
+        red "FAIL: $base (output mismatch)"
+        ((FAIL++))
+    else
+        green "PASS: $base"
+        ((PASS++))
+    fi
+}
+
+{ printf 'print '; repeat '(' "$DEPTH"; printf '1'; repeat ')' "$DEPTH"; printf ';\n'; } > "$stress_let"
+stress "stress_parens" 1 "$stress_let" -e
+
+{ printf 'print '; repeat '-' "$DEPTH"; printf '1;\n'; } > "$stress_let"
+if ((DEPTH % 2)); then expected=18446744073709551615; else expected=1; fi
+stress "stress_unary" "$expected" "$stress_let" -e
+
+{ printf 'print '; repeat '1+' "$DEPTH"; printf '1;\n'; } > "$stress_let"
+stress "stress_left" "$((DEPTH + 1))" "$stress_let" -e
+
+{ printf 'print '; repeat '1-(' "$DEPTH"; printf '1'; repeat ')' "$DEPTH"; printf ';\n'; } > "$stress_let"
+"$LET" "$stress_let" -d > "$stress_dump" 2> /dev/null
+stress "stress_right" "$((DEPTH % 2 ? 0 : 1))" "$stress_let" -e
+stress "stress_right_dump" "$((DEPTH % 2 ? 0 : 1))" "$stress_dump" -e
+
+# Parallel dump must be byte-identical to the sequential one
+repeat 'let x = (x + 1) * -x / 3; print x - 1;' 100000 > "$stress_let"
+"$LET" "$stress_let" -d > "$stress_dump" 2> /dev/null
+stress "dump_jobs" "$(cat "$stress_dump")" "$stress_let" -d -j 4
+
+# Profiling must neither change the output nor choke on deep nesting; folded stacks are "<frame>;...;<frame> <ns>"
+stress_folded=$(mktemp)
+trap 'rm -f "$stdout_tmp" "$stderr_tmp" "$stress_let" "$stress_dump" "$stress_folded"' EXIT
+stress "profile" "$("$LET" "$stress_let" -e 2> /dev/null)" "$stress_let" --folded "$stress_folded"
+((TOTAL++))
+if grep -q 'print@' "$stress_folded" && ! grep -qvE '^[^;]+(;[^;]+)* [0-9]+$' "$stress_folded"; then
+    green "PASS: profile_folded"
+    ((PASS++))
+else
+    red "FAIL: profile_folded"
+    head -n 5 "$stress_folded" | sed 's/^/  /'
+    ((FAIL++))
+fi
+{ printf 'print '; repeat '1-(' "$DEPTH"; printf '1'; repeat ')' "$DEPTH"; printf ';\n'; } > "$stress_let"
+stress "stress_profile" "$((DEPTH % 2 ? 0 : 1))" "$stress_let" -p
+
+# --max-errors stops right away - even if the input is huge
+repeat 'print *; ' 1000000 > "$stress_let"
+((TOTAL++))
+"$LET" "$stress_let" --max-errors 3 > /dev/null 2> "$stderr_tmp"
+if [[ $? -ne 0 && $(grep -c ': error: ' "$stderr_tmp") -eq 3 ]] && grep -qF "3 error(s) encountered" "$stderr_tmp"; then
+    green "PASS: max_errors"
+    ((PASS++))
+else
+    red "FAIL: max_errors"
+    head -c 1000 "$stderr_tmp" | sed 's/^/  /'
+    ((FAIL++))
+fi
+
+# Lazy evaluation neither recurses along chains of bindings nor into deep expressions
+{ repeat 'let x = x + 1; ' 1000000; printf 'print x;\n'; } > "$stress_let"
+stress "stress_lazy_chain" 1000000 "$stress_let" -l
+{ printf 'let x = '; repeat '1-(' "$DEPTH"; printf '1'; repeat ')' "$DEPTH"; printf ';\nprint x;\n'; } > "$stress_let"
+stress "stress_lazy_right" "$((DEPTH % 2 ? 0 : 1))" "$stress_let" -l
+
+# Batch mode emits the same as one process per file - in input order, no matter how many threads
+inputs=(test/*.let test/error/*.let test/nonexistent.let)
+expected_out=$(for f in "${inputs[@]}"; do "$LET" "$f" -e 2> /dev/null; done)
+expected_err=$(for f in "${inputs[@]}"; do "$LET" "$f" -e 2>&1 > /dev/null; done)
+printf '%s\n' "${inputs[@]}" > "$stress_let"
+# batch <name> <let args>...
+batch() {
+    local base=$1
+    shift
+    ((TOTAL++))
+    "$LET" -e "$@" > "$stdout_tmp" 2> "$stderr_tmp"
+    rc=$?
+    if [[ $rc -ne 0 && "$(cat "$stdout_tmp")" == "$expected_out" && "$(cat "$stderr_tmp")" == "$expected_err" ]]; then
+        green "PASS: $base"
+        ((PASS++))
+    else
+        red "FAIL: $base (exit code $rc)"
+        diff <(echo "$expected_out"; echo "$expected_err") <(cat "$stdout_tmp" "$stderr_tmp") | head -n 10 | sed 's/^/  /'
+        ((FAIL++))
+    fi
+}
+
+batch "batch_files" "${inputs[@]}" -j 4
+batch "batch_list" "@$stress_let" -j 0
+batch "batch_list_sequential" "@$stress_let"
+batch "batch_lazy" "${inputs[@]}" -l -j 4
+
+# --folded needs a single input - with or without --timing; --profile is eager only
+stress "timing_folded" "$(cat test/eval.out)" test/eval.let -t --folded "$stress_folded"
+((TOTAL++))
+if ! "$LET" test/eval.let -p -l > /dev/null 2> "$stderr_tmp" && grep -qF -- "--lazy" "$stderr_tmp"; then
+    green "PASS: profile_lazy"
+    ((PASS++))
+else
+    red "FAIL: profile_lazy (expected --profile --lazy to be rejected)"
+    ((FAIL++))
+fi
+
+# Embedding API: let-api-test is built next to let
+api="$(dirname "$LET")/let-api-test"
+[[ "$LET" == *.exe ]] && api+=.exe
+((TOTAL++))
+if [[ ! -x "$api" ]]; then
+    red "FAIL: api (missing $api; configure with -DLET_BUILD_TESTS=ON)"
+    ((FAIL++))
+elif "$api" > "$stdout_tmp" 2> "$stderr_tmp"; then
+    green "PASS: api"
+    ((PASS++))
+else
+    red "FAIL: api"
+    sed 's/^/  /' "$stderr_tmp"
+    ((FAIL++))
+fi
+
 echo
 echo "$PASS/$TOTAL passed, $FAIL failed"
 [[ $FAIL -eq 0 ]]